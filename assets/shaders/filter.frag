@@ -6,6 +6,7 @@ out vec4 FragColor;
 uniform sampler2D uTexture;
 uniform int uMode;   // 0 -> original , 1 -> mean filter applied
 uniform int uRadius; // kernel radius for mean filter
+uniform int uLod;    // source mip level the mean filter reads from (0 = full res)
 
 // 3x3 mean filter
 void main() {
@@ -17,11 +18,12 @@ void main() {
         int r = clamp(uRadius, 1, 50);
         int kernelSize = 2 * r + 1;
         float invCount = 1.0 / float(kernelSize * kernelSize);
-        vec2 texel = 1.0 / vec2(textureSize(uTexture, 0));
+        vec2 texel = 1.0 / vec2(textureSize(uTexture, uLod));
+        float lod = float(uLod);
         vec3 sum = vec3(0.0);
         for (int dy = -r; dy <= r; ++dy) {
             for (int dx = -r; dx <= r; ++dx) {
-                sum += texture(uTexture, vUV + vec2(dx, dy) * texel).rgb;
+                sum += textureLod(uTexture, vUV + vec2(dx, dy) * texel, lod).rgb;
             }
         }
         color = sum * invCount;
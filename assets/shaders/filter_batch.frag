@@ -0,0 +1,30 @@
+#version 330 core
+
+in vec2 vUV;
+flat in ivec2 vParams; // x: 0 -> original , 1 -> mean filter applied; y: kernel radius
+flat in int vLayer;
+out vec4 FragColor;
+
+uniform sampler2DArray uTexture;
+
+// Mean filter from filter.frag, reading the array layer this instance writes to.
+void main() {
+    float layer = float(vLayer);
+    vec3 color;
+    if (vParams.x == 0) {
+        color = texture(uTexture, vec3(vUV, layer)).rgb; // original
+    } else {
+        int r = clamp(vParams.y, 1, 50);
+        int kernelSize = 2 * r + 1;
+        float invCount = 1.0 / float(kernelSize * kernelSize);
+        vec2 texel = 1.0 / vec2(textureSize(uTexture, 0).xy);
+        vec3 sum = vec3(0.0);
+        for (int dy = -r; dy <= r; ++dy) {
+            for (int dx = -r; dx <= r; ++dx) {
+                sum += textureLod(uTexture, vec3(vUV + vec2(dx, dy) * texel, layer), 0.0).rgb;
+            }
+        }
+        color = sum * invCount;
+    }
+    FragColor = vec4(color, 1.0);
+}
@@ -0,0 +1,17 @@
+#version 330 core
+
+layout(location = 0) in vec2 aPos;
+layout(location = 1) in vec2 aUV;
+layout(location = 2) in ivec2 aParams; // per instance: (mode, radius), see BatchLayerParams
+
+out vec2 gUV;
+flat out ivec2 gParams;
+flat out int gLayer;
+
+// One instance per array layer.
+void main() {
+    gUV = aUV;
+    gParams = aParams;
+    gLayer = gl_InstanceID;
+    gl_Position = vec4(aPos, 0.0, 1.0);
+}
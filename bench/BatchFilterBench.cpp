@@ -0,0 +1,287 @@
+// Compares images/s of the per-image filter path (one texture, FBO and draw per image, as in
+// main.cpp) against gfx::BatchFilter (one texture array, layered FBO and instanced draw).
+//
+// Usage: CG_TP_3_bench [image size in pixels, 1..2048, default 256]
+
+#include "BatchFilter.hpp"
+#include "GLUtils.hpp"
+#include "ShaderProgram.hpp"
+#include "TextureLoader.hpp"
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr int kBatchSizes[] = {16, 32, 64, 128, 256};
+constexpr int kImagesPerRun = 2048; // each measurement filters at least this many images
+constexpr int kMaxRadius = 5;       // radii cycle 1..kMaxRadius like the demo slider
+constexpr int kPassThroughEvery = 7; // every 7th image uses mode 0 so the mode attribute is exercised too
+constexpr int kMaxImageSize = 2048;  // 256 layers at this size already need several GiB across both paths
+constexpr int kMaxChannelDiff = 1;   // same math via sampler2D vs sampler2DArray; allow rounding noise
+
+bool InitGL(GLFWwindow*& window) {
+    if (!gfx::CreateGLWindow(64, 64, "CG_TP_3 - Batch Filter Bench", false, window)) {
+        return false;
+    }
+    glfwSwapInterval(0);
+    glDisable(GL_DEPTH_TEST);
+    return true;
+}
+
+// Distinct synthetic content per image, so a result routed to the wrong layer fails verification.
+gfx::ImageRGBA8 MakeImage(GLsizei size, int seed) {
+    const GLsizei cell = 2 + seed % 13;
+    gfx::ImageRGBA8 image;
+    image.width = size;
+    image.height = size;
+    image.pixels.resize(static_cast<std::size_t>(size) * size * 4);
+    for (GLsizei y = 0; y < size; ++y) {
+        for (GLsizei x = 0; x < size; ++x) {
+            unsigned char* p = &image.pixels[(static_cast<std::size_t>(y) * size + x) * 4];
+            p[0] = static_cast<unsigned char>(((x + seed * 7) * 255) / size);
+            p[1] = static_cast<unsigned char>(((y + seed * 3) * 255) / size);
+            p[2] = static_cast<unsigned char>(((x / cell + y / cell) % 2) * 255);
+            p[3] = 0xFF;
+        }
+    }
+    return image;
+}
+
+struct SingleTarget {
+    GLuint source = 0;
+    GLuint fbo = 0;
+    GLuint tex = 0;
+};
+
+// Per-image resources as main.cpp builds them: a LoadTexture2D-style source and a cache FBO.
+SingleTarget CreateSingleTarget(const gfx::ImageRGBA8& image) {
+    SingleTarget t;
+    gfx::CreateTexture2D(image, t.source);
+    t.fbo = gfx::CreateFramebufferWithTexture(image.width, image.height, t.tex);
+    return t;
+}
+
+void DestroySingleTarget(SingleTarget& t) {
+    glDeleteTextures(1, &t.source);
+    glDeleteTextures(1, &t.tex);
+    glDeleteFramebuffers(1, &t.fbo);
+    t = {};
+}
+
+gfx::BatchLayerParams MakeParams(int index) {
+    gfx::BatchLayerParams params;
+    params.mode = (index % kPassThroughEvery == kPassThroughEvery - 1) ? 0 : 1;
+    params.radius = 1 + index % kMaxRadius;
+    return params;
+}
+
+// One full pass over the batch the way main.cpp fills its cache, image by image.
+void FilterPerImage(const std::vector<SingleTarget>& targets,
+                    const std::vector<gfx::BatchLayerParams>& params,
+                    const ShaderProgram& program, const gfx::QuadMesh& quad, GLsizei size) {
+    for (std::size_t i = 0; i < targets.size(); ++i) {
+        glBindFramebuffer(GL_FRAMEBUFFER, targets[i].fbo);
+        glViewport(0, 0, size, size);
+
+        program.Use();
+        program.SetInt("uMode", params[i].mode);
+        program.SetInt("uTexture", 0);
+        program.SetInt("uLod", 0);
+        program.SetInt("uRadius", params[i].radius);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, targets[i].source);
+
+        gfx::DrawQuad(quad);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+std::vector<unsigned char> ReadFramebuffer(GLuint fbo, GLsizei size) {
+    std::vector<unsigned char> pixels(static_cast<std::size_t>(size) * size * 4);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glReadPixels(0, 0, size, size, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    return pixels;
+}
+
+// Filters the batch once both ways and compares a spread of layers (different radii, a
+// pass-through layer, first and last), so broken gl_Layer routing, instance attributes or
+// layered FBO output fail the run instead of showing up as a speedup.
+bool VerifyBatch(const std::vector<SingleTarget>& targets,
+                 const std::vector<gfx::BatchLayerParams>& params, GLuint sourceArray,
+                 const ShaderProgram& program, const gfx::QuadMesh& quad,
+                 gfx::BatchFilter& batch, GLsizei size, std::string* error) {
+    FilterPerImage(targets, params, program, quad, size);
+    if (!batch.Apply(sourceArray, size, size, params, error)) {
+        return false;
+    }
+
+    // Read layers one at a time through a single-layer attachment rather than pulling the
+    // whole array back with glGetTexImage.
+    GLuint layerFbo = 0;
+    glGenFramebuffers(1, &layerFbo);
+
+    const std::size_t last = targets.size() - 1;
+    const std::size_t layers[] = {0, 1, std::min<std::size_t>(kPassThroughEvery - 1, last), last / 2, last};
+    bool ok = true;
+    for (std::size_t layer : layers) {
+        std::vector<unsigned char> expected = ReadFramebuffer(targets[layer].fbo, size);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, layerFbo);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, batch.GetOutput(), 0,
+                                  static_cast<GLint>(layer));
+        std::vector<unsigned char> actual = ReadFramebuffer(layerFbo, size);
+
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            if (std::abs(static_cast<int>(expected[i]) - static_cast<int>(actual[i])) > kMaxChannelDiff) {
+                std::size_t pixel = i / 4;
+                if (error) {
+                    *error = "Batched layer " + std::to_string(layer) + " (mode " +
+                             std::to_string(params[layer].mode) + ", radius " +
+                             std::to_string(params[layer].radius) + ") differs from the per-image result at (" +
+                             std::to_string(pixel % size) + ", " + std::to_string(pixel / size) + "): " +
+                             std::to_string(actual[i]) + " vs " + std::to_string(expected[i]) + ".";
+                }
+                ok = false;
+                break;
+            }
+        }
+        if (!ok) {
+            break;
+        }
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &layerFbo);
+    return ok;
+}
+
+template <typename Pass>
+double MeasureImagesPerSecond(int batchSize, Pass&& pass) {
+    const int runs = std::max(4, kImagesPerRun / batchSize);
+    pass(); // warm-up: driver shader/state compilation
+    glFinish();
+    double start = glfwGetTime();
+    for (int run = 0; run < runs; ++run) {
+        pass();
+    }
+    glFinish();
+    double elapsed = glfwGetTime() - start;
+    return elapsed > 0.0 ? (static_cast<double>(runs) * batchSize) / elapsed : 0.0;
+}
+
+// Owns every GL object the benchmark creates, so all of them (including ShaderProgram and
+// BatchFilter destructors) are released while the context is still current.
+int RunBenchmark(GLsizei size) {
+    const fs::path shaderDir = fs::path(PROJECT_SOURCE_DIR) / "assets" / "shaders";
+    ShaderProgram program;
+    gfx::BatchFilter batch;
+    std::string error;
+    if (!program.LoadFromFiles(shaderDir / "filter.vert", shaderDir / "filter.frag", &error) ||
+        !batch.Init(shaderDir, &error)) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+
+    gfx::QuadMesh quad = gfx::CreateFullscreenQuad();
+
+    std::printf("%dx%d images, radius cycling 1..%d, every %dth unfiltered; outputs verified before timing\n",
+                size, size, kMaxRadius, kPassThroughEvery);
+    std::printf("%8s %16s %16s %8s\n", "batch", "per-image img/s", "batched img/s", "speedup");
+
+    int exitCode = 0;
+    for (int batchSize : kBatchSizes) {
+        std::vector<gfx::ImageRGBA8> images;
+        std::vector<gfx::BatchLayerParams> params;
+        for (int i = 0; i < batchSize; ++i) {
+            images.push_back(MakeImage(size, i));
+            params.push_back(MakeParams(i));
+        }
+
+        std::vector<SingleTarget> targets;
+        for (const gfx::ImageRGBA8& image : images) {
+            targets.push_back(CreateSingleTarget(image));
+        }
+        GLuint sourceArray = 0;
+        if (!gfx::CreateTextureArray2D(images, sourceArray, &error)) {
+            std::cerr << error << "\n";
+            for (SingleTarget& t : targets) {
+                DestroySingleTarget(t);
+            }
+            exitCode = 1;
+            break;
+        }
+
+        bool batchOk = VerifyBatch(targets, params, sourceArray, program, quad, batch, size, &error);
+        double perImage = 0.0;
+        double batched = 0.0;
+        if (batchOk) {
+            perImage = MeasureImagesPerSecond(batchSize, [&] {
+                FilterPerImage(targets, params, program, quad, size);
+            });
+            batched = MeasureImagesPerSecond(batchSize, [&] {
+                batchOk = batch.Apply(sourceArray, size, size, params, &error) && batchOk;
+            });
+        }
+
+        glDeleteTextures(1, &sourceArray);
+        for (SingleTarget& t : targets) {
+            DestroySingleTarget(t);
+        }
+        if (!batchOk) {
+            std::cerr << error << "\n";
+            exitCode = 1;
+            break;
+        }
+
+        std::printf("%8d %16.0f %16.0f %7.2fx\n", batchSize, perImage, batched,
+                    perImage > 0.0 ? batched / perImage : 0.0);
+    }
+
+    gfx::DestroyMesh(quad);
+    return exitCode;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    GLsizei size = 256;
+    if (argc > 1) {
+        size = std::atoi(argv[1]);
+        if (size < 1 || size > kMaxImageSize) {
+            std::cerr << "Image size must be between 1 and " << kMaxImageSize << "\n";
+            return 1;
+        }
+    }
+
+    GLFWwindow* window = nullptr;
+    if (!InitGL(window)) {
+        return 1;
+    }
+
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    if (size > maxTextureSize) {
+        std::cerr << "Image size exceeds GL_MAX_TEXTURE_SIZE (" << maxTextureSize << ")\n";
+        glfwDestroyWindow(window);
+        glfwTerminate();
+        return 1;
+    }
+
+    int exitCode = RunBenchmark(size);
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return exitCode;
+}
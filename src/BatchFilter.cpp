@@ -0,0 +1,154 @@
+#include "BatchFilter.hpp"
+
+#include <cstddef>
+
+namespace gfx {
+
+BatchFilter::~BatchFilter() {
+    Destroy();
+}
+
+bool BatchFilter::Init(const std::filesystem::path& shaderDir, std::string* error) {
+    if (!program_.LoadFromFiles(shaderDir / "filter_batch.vert",
+                                shaderDir / "filter_batch.geom",
+                                shaderDir / "filter_batch.frag", error)) {
+        return false;
+    }
+    program_.Use();
+    program_.SetInt("uTexture", 0);
+    glUseProgram(0);
+
+    Destroy();
+    quad_ = CreateFullscreenQuad();
+    glGenBuffers(1, &paramsVbo_);
+
+    // Per-instance (mode, radius) on top of the quad's attributes; one instance per layer.
+    glBindVertexArray(quad_.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, paramsVbo_);
+    glVertexAttribIPointer(2, 2, GL_INT, sizeof(BatchLayerParams),
+                           reinterpret_cast<void*>(offsetof(BatchLayerParams, mode)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return true;
+}
+
+bool BatchFilter::Apply(GLuint sourceArray, GLsizei width, GLsizei height,
+                        const std::vector<BatchLayerParams>& params,
+                        std::string* error) {
+    if (params.empty()) {
+        if (error) {
+            *error = "Batch filter needs at least one layer.";
+        }
+        return false;
+    }
+    const GLsizei layers = static_cast<GLsizei>(params.size());
+    if (!EnsureOutput(width, height, layers, error)) {
+        return false;
+    }
+
+    // Orphan and refill; the previous batch may still be in flight.
+    glBindBuffer(GL_ARRAY_BUFFER, paramsVbo_);
+    glBufferData(GL_ARRAY_BUFFER, params.size() * sizeof(BatchLayerParams), params.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    GLint prevViewport[4];
+    glGetIntegerv(GL_VIEWPORT, prevViewport);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    glViewport(0, 0, width, height);
+
+    program_.Use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, sourceArray);
+
+    glBindVertexArray(quad_.vao);
+    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr, layers);
+    glBindVertexArray(0);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+    return true;
+}
+
+bool BatchFilter::EnsureOutput(GLsizei width, GLsizei height, GLsizei layers, std::string* error) {
+    if (outputTex_ && width == width_ && height == height_ && layers == layers_) {
+        return true;
+    }
+    DestroyOutput();
+
+    GLint maxLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    if (layers > maxLayers) {
+        if (error) {
+            *error = "Batch exceeds GL_MAX_ARRAY_TEXTURE_LAYERS (" + std::to_string(maxLayers) + ").";
+        }
+        return false;
+    }
+
+    // Drop stale errors so the check below only sees this allocation.
+    while (glGetError() != GL_NO_ERROR) {
+    }
+
+    glGenTextures(1, &outputTex_);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, outputTex_);
+    // Use linear RGBA8 to avoid sRGB double-decoding when blits/sample again.
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, layers, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    GLenum allocError = glGetError();
+    if (allocError != GL_NO_ERROR) {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        DestroyOutput();
+        if (error) {
+            *error = "Unable to allocate " + std::to_string(width) + "x" + std::to_string(height) + "x" +
+                     std::to_string(layers) + " output array (GL error " + std::to_string(allocError) + ").";
+        }
+        return false;
+    }
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    // Attaching the whole array makes the framebuffer layered; gl_Layer picks the target.
+    glGenFramebuffers(1, &fbo_);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, outputTex_, 0);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        DestroyOutput();
+        if (error) {
+            *error = "Layered framebuffer incomplete: " + std::to_string(status);
+        }
+        return false;
+    }
+
+    width_ = width;
+    height_ = height;
+    layers_ = layers;
+    return true;
+}
+
+void BatchFilter::DestroyOutput() {
+    if (fbo_) glDeleteFramebuffers(1, &fbo_);
+    if (outputTex_) glDeleteTextures(1, &outputTex_);
+    fbo_ = 0;
+    outputTex_ = 0;
+    width_ = 0;
+    height_ = 0;
+    layers_ = 0;
+}
+
+void BatchFilter::Destroy() {
+    DestroyOutput();
+    if (paramsVbo_) glDeleteBuffers(1, &paramsVbo_);
+    if (quad_.vao) DestroyMesh(quad_);
+    paramsVbo_ = 0;
+}
+
+} // namespace gfx
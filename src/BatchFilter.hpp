@@ -0,0 +1,56 @@
+#pragma once
+
+#include "GLUtils.hpp"
+#include "ShaderProgram.hpp"
+
+#include <GL/glew.h>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace gfx {
+
+// Per-layer filter settings, fed to the batch draw as an instance attribute.
+struct BatchLayerParams {
+    GLint mode = 1;   // 0 -> original , 1 -> mean filter applied (as uMode in filter.frag)
+    GLint radius = 1; // kernel radius for mean filter
+};
+
+// Filters every layer of a GL_TEXTURE_2D_ARRAY with one instanced draw into a layered
+// framebuffer, instead of one texture, FBO and draw per image.
+class BatchFilter {
+public:
+    BatchFilter() = default;
+    ~BatchFilter();
+
+    BatchFilter(const BatchFilter&) = delete;
+    BatchFilter& operator=(const BatchFilter&) = delete;
+
+    // Loads filter_batch.{vert,geom,frag} from shaderDir and creates the quad/instance buffers.
+    bool Init(const std::filesystem::path& shaderDir, std::string* error = nullptr);
+
+    // Filters layer i of sourceArray (width x height, params.size() layers) with params[i].
+    // The output array is reallocated only when the size or layer count changes.
+    bool Apply(GLuint sourceArray, GLsizei width, GLsizei height,
+               const std::vector<BatchLayerParams>& params,
+               std::string* error = nullptr);
+
+    GLuint GetOutput() const { return outputTex_; }
+    GLsizei GetLayerCount() const { return layers_; }
+
+private:
+    ShaderProgram program_;
+    QuadMesh quad_;
+    GLuint paramsVbo_ = 0;
+    GLuint fbo_ = 0;
+    GLuint outputTex_ = 0;
+    GLsizei width_ = 0;
+    GLsizei height_ = 0;
+    GLsizei layers_ = 0;
+
+    bool EnsureOutput(GLsizei width, GLsizei height, GLsizei layers, std::string* error);
+    void DestroyOutput();
+    void Destroy();
+};
+
+} // namespace gfx
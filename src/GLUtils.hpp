@@ -0,0 +1,29 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+namespace gfx {
+
+// Initializes GLFW, opens a window with a GL 3.3 core context, makes it current and loads GLEW.
+// Prints the failure reason to std::cerr and returns false on error.
+bool CreateGLWindow(int width, int height, const char* title, bool visible, GLFWwindow*& outWindow);
+
+// Linear RGBA8 colour texture with clamp-to-edge sampling, suitable as a render target.
+GLuint CreateColorTexture(GLsizei width, GLsizei height);
+
+// Framebuffer with a fresh colour texture (returned in outTex) as its only attachment.
+GLuint CreateFramebufferWithTexture(GLsizei width, GLsizei height, GLuint& outTex);
+
+struct QuadMesh {
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    GLuint ebo = 0;
+};
+
+// Fullscreen quad with position at attribute 0 and UV at attribute 1, drawn as 6 indices.
+QuadMesh CreateFullscreenQuad();
+void DrawQuad(const QuadMesh& mesh);
+void DestroyMesh(QuadMesh& mesh);
+
+} // namespace gfx
@@ -25,11 +25,29 @@ ShaderProgram& ShaderProgram::operator=(ShaderProgram&& other) noexcept {
 bool ShaderProgram::LoadFromFiles(const std::filesystem::path& vertexPath,
                                   const std::filesystem::path& fragmentPath,
                                   std::string* error) {
+    return LoadStages(vertexPath, nullptr, fragmentPath, error);
+}
+
+bool ShaderProgram::LoadFromFiles(const std::filesystem::path& vertexPath,
+                                  const std::filesystem::path& geometryPath,
+                                  const std::filesystem::path& fragmentPath,
+                                  std::string* error) {
+    return LoadStages(vertexPath, &geometryPath, fragmentPath, error);
+}
+
+bool ShaderProgram::LoadStages(const std::filesystem::path& vertexPath,
+                               const std::filesystem::path* geometryPath,
+                               const std::filesystem::path& fragmentPath,
+                               std::string* error) {
     std::string vertexSource;
+    std::string geometrySource;
     std::string fragmentSource;
     if (!ReadFile(vertexPath, vertexSource, error) || !ReadFile(fragmentPath, fragmentSource, error)) {
         return false;
     }
+    if (geometryPath && !ReadFile(*geometryPath, geometrySource, error)) {
+        return false;
+    }
 
     std::string compileError;
     GLuint vertexShader = CompileShader(GL_VERTEX_SHADER, vertexSource, compileError);
@@ -40,9 +58,24 @@ bool ShaderProgram::LoadFromFiles(const std::filesystem::path& vertexPath,
         return false;
     }
 
+    GLuint geometryShader = 0;
+    if (geometryPath) {
+        geometryShader = CompileShader(GL_GEOMETRY_SHADER, geometrySource, compileError);
+        if (!geometryShader) {
+            glDeleteShader(vertexShader);
+            if (error) {
+                *error = "Geometry shader error: " + compileError;
+            }
+            return false;
+        }
+    }
+
     GLuint fragmentShader = CompileShader(GL_FRAGMENT_SHADER, fragmentSource, compileError);
     if (!fragmentShader) {
         glDeleteShader(vertexShader);
+        if (geometryShader) {
+            glDeleteShader(geometryShader);
+        }
         if (error) {
             *error = "Fragment shader error: " + compileError;
         }
@@ -51,6 +84,9 @@ bool ShaderProgram::LoadFromFiles(const std::filesystem::path& vertexPath,
 
     GLuint program = glCreateProgram();
     glAttachShader(program, vertexShader);
+    if (geometryShader) {
+        glAttachShader(program, geometryShader);
+    }
     glAttachShader(program, fragmentShader);
     glLinkProgram(program);
 
@@ -65,6 +101,9 @@ bool ShaderProgram::LoadFromFiles(const std::filesystem::path& vertexPath,
             *error = "Program link error: " + std::string(log.data());
         }
         glDeleteShader(vertexShader);
+        if (geometryShader) {
+            glDeleteShader(geometryShader);
+        }
         glDeleteShader(fragmentShader);
         glDeleteProgram(program);
         return false;
@@ -74,6 +113,10 @@ bool ShaderProgram::LoadFromFiles(const std::filesystem::path& vertexPath,
     glDetachShader(program, fragmentShader);
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
+    if (geometryShader) {
+        glDetachShader(program, geometryShader);
+        glDeleteShader(geometryShader);
+    }
 
     Destroy();
     program_ = program;
@@ -20,6 +20,11 @@ public:
     bool LoadFromFiles(const std::filesystem::path& vertexPath,
                        const std::filesystem::path& fragmentPath,
                        std::string* error = nullptr);
+    // Same as above with a geometry stage between vertex and fragment.
+    bool LoadFromFiles(const std::filesystem::path& vertexPath,
+                       const std::filesystem::path& geometryPath,
+                       const std::filesystem::path& fragmentPath,
+                       std::string* error = nullptr);
 
     void Use() const;
     GLuint GetHandle() const { return program_; }
@@ -34,6 +39,10 @@ private:
     GLuint program_ = 0;
 
     GLint GetUniformLocation(const std::string& name) const;
+    bool LoadStages(const std::filesystem::path& vertexPath,
+                    const std::filesystem::path* geometryPath,
+                    const std::filesystem::path& fragmentPath,
+                    std::string* error);
     GLuint CompileShader(GLenum type, const std::string& source, std::string& error);
     static bool ReadFile(const std::filesystem::path& path, std::string& out, std::string* error);
     void Destroy();
@@ -5,6 +5,7 @@
 #include <cstdio>
 #include <memory>
 #include <setjmp.h>
+#include <utility>
 #include <vector>
 
 namespace gfx {
@@ -20,9 +21,9 @@ struct FileCloser {
 
 } // namespace
 
-bool LoadTexture2D(const std::filesystem::path& path,
-                   GLuint& outTexture,
-                   std::string* error) {
+bool LoadImageRGBA8(const std::filesystem::path& path,
+                    ImageRGBA8& outImage,
+                    std::string* error) {
     std::unique_ptr<FILE, FileCloser> file(std::fopen(path.string().c_str(), "rb"));
     if (!file) {
         if (error) {
@@ -112,11 +113,29 @@ bool LoadTexture2D(const std::filesystem::path& path,
     png_read_image(pngPtr, rowPointers.data());
     png_destroy_read_struct(&pngPtr, &infoPtr, nullptr);
 
+    outImage.width = static_cast<GLsizei>(width);
+    outImage.height = static_cast<GLsizei>(height);
+    outImage.pixels = std::move(imageData);
+    return true;
+}
+
+bool LoadTexture2D(const std::filesystem::path& path,
+                   GLuint& outTexture,
+                   std::string* error) {
+    ImageRGBA8 image;
+    if (!LoadImageRGBA8(path, image, error)) {
+        return false;
+    }
+    CreateTexture2D(image, outTexture);
+    return true;
+}
+
+void CreateTexture2D(const ImageRGBA8& image, GLuint& outTexture) {
     glGenTextures(1, &outTexture);
     glBindTexture(GL_TEXTURE_2D, outTexture);
     // Store as linear RGBA8 to avoid unintended double sRGB conversions in passes.
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, static_cast<GLsizei>(width),
-                 static_cast<GLsizei>(height), 0, GL_RGBA, GL_UNSIGNED_BYTE, imageData.data());
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, image.width, image.height, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.data());
     glGenerateMipmap(GL_TEXTURE_2D);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
@@ -125,8 +144,89 @@ bool LoadTexture2D(const std::filesystem::path& path,
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
     glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+bool CreateTextureArray2D(const std::vector<ImageRGBA8>& images,
+                          GLuint& outTexture,
+                          std::string* error) {
+    if (images.empty()) {
+        if (error) {
+            *error = "Texture array needs at least one image.";
+        }
+        return false;
+    }
+
+    GLint maxLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    if (images.size() > static_cast<std::size_t>(maxLayers)) {
+        if (error) {
+            *error = "Texture array exceeds GL_MAX_ARRAY_TEXTURE_LAYERS (" + std::to_string(maxLayers) + ").";
+        }
+        return false;
+    }
+
+    const GLsizei width = images.front().width;
+    const GLsizei height = images.front().height;
+    for (const ImageRGBA8& image : images) {
+        if (image.width != width || image.height != height) {
+            if (error) {
+                *error = "Texture array images must all be " + std::to_string(width) + "x" +
+                         std::to_string(height) + ".";
+            }
+            return false;
+        }
+    }
+
+    // Drop stale errors so the checks below only see this texture's allocations.
+    while (glGetError() != GL_NO_ERROR) {
+    }
+
+    const GLsizei layers = static_cast<GLsizei>(images.size());
+    glGenTextures(1, &outTexture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, outTexture);
+    // Same format and sampling as CreateTexture2D so per-layer results match the single-image path.
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, layers, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    GLenum glError = glGetError();
+    if (glError == GL_NO_ERROR) {
+        for (GLsizei layer = 0; layer < layers; ++layer) {
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, width, height, 1,
+                            GL_RGBA, GL_UNSIGNED_BYTE, images[layer].pixels.data());
+        }
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+        glError = glGetError();
+    }
+    if (glError != GL_NO_ERROR) {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        glDeleteTextures(1, &outTexture);
+        outTexture = 0;
+        if (error) {
+            *error = "Unable to allocate " + std::to_string(width) + "x" + std::to_string(height) + "x" +
+                     std::to_string(layers) + " texture array (GL error " + std::to_string(glError) + ").";
+        }
+        return false;
+    }
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
     return true;
 }
 
+bool LoadTextureArray2D(const std::vector<std::filesystem::path>& paths,
+                        GLuint& outTexture,
+                        std::string* error) {
+    std::vector<ImageRGBA8> images(paths.size());
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        if (!LoadImageRGBA8(paths[i], images[i], error)) {
+            return false;
+        }
+    }
+    return CreateTextureArray2D(images, outTexture, error);
+}
+
 } // namespace gfx
 
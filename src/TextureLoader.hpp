@@ -3,13 +3,39 @@
 #include <GL/glew.h>
 #include <filesystem>
 #include <string>
+#include <vector>
 
 namespace gfx {
 
+// RGBA8 pixels, bottom row first (OpenGL order).
+struct ImageRGBA8 {
+    GLsizei width = 0;
+    GLsizei height = 0;
+    std::vector<unsigned char> pixels;
+};
+
+// Decodes a PNG into CPU memory using libpng.
+bool LoadImageRGBA8(const std::filesystem::path& path,
+                    ImageRGBA8& outImage,
+                    std::string* error = nullptr);
+
 // Loads a PNG texture into GPU memory using libpng.
 bool LoadTexture2D(const std::filesystem::path& path,
                    GLuint& outTexture,
                    std::string* error = nullptr);
 
+// Uploads decoded pixels as a mipmapped GL_TEXTURE_2D (what LoadTexture2D does after decoding).
+void CreateTexture2D(const ImageRGBA8& image, GLuint& outTexture);
+
+// Packs same-sized images into the layers of a GL_TEXTURE_2D_ARRAY (one image per layer).
+bool CreateTextureArray2D(const std::vector<ImageRGBA8>& images,
+                          GLuint& outTexture,
+                          std::string* error = nullptr);
+
+// Loads same-sized PNGs into the layers of a GL_TEXTURE_2D_ARRAY.
+bool LoadTextureArray2D(const std::vector<std::filesystem::path>& paths,
+                        GLuint& outTexture,
+                        std::string* error = nullptr);
+
 } // namespace gfx
 
@@ -1,9 +1,12 @@
+#include "GLUtils.hpp"
 #include "ShaderProgram.hpp"
 #include "TextureLoader.hpp"
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
 #include <iostream>
 #include <vector>
@@ -17,32 +20,13 @@ void FramebufferSizeCallback(GLFWwindow*, int width, int height) {
 }
 
 bool InitGL(GLFWwindow*& window) {
-    if (!glfwInit()) {
-        std::cerr << "Failed to initialize GLFW\n";
+    if (!gfx::CreateGLWindow(1920, 1080, "CG_TP_3 - Image Filter", true, window)) {
         return false;
     }
 
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-    window = glfwCreateWindow(1920, 1080, "CG_TP_3 - Image Filter", nullptr, nullptr);
-    if (!window) {
-        std::cerr << "Failed to create GLFW window\n";
-        glfwTerminate();
-        return false;
-    }
-
-    glfwMakeContextCurrent(window);
     glfwSwapInterval(1);
     glfwSetFramebufferSizeCallback(window, FramebufferSizeCallback);
 
-    glewExperimental = GL_TRUE;
-    if (glewInit() != GLEW_OK) {
-        std::cerr << "Failed to initialize GLEW\n";
-        return false;
-    }
-
     int width, height;
     glfwGetFramebufferSize(window, &width, &height);
     glViewport(0, 0, width, height);
@@ -80,82 +64,155 @@ struct CachedBlur {
     bool ready = false;
 };
 
-GLuint CreateColorTexture(GLsizei width, GLsizei height) {
-    GLuint tex = 0;
-    glGenTextures(1, &tex);
-    glBindTexture(GL_TEXTURE_2D, tex);
-    // Use linear RGBA8 to avoid sRGB double-decoding when blits/sample again.
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    return tex;
-}
-
-GLuint CreateFramebufferWithTexture(GLsizei width, GLsizei height, GLuint& outTex) {
-    outTex = CreateColorTexture(width, height);
-    GLuint fbo = 0;
-    glGenFramebuffers(1, &fbo);
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, outTex, 0);
-    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-    if (status != GL_FRAMEBUFFER_COMPLETE) {
-        std::cerr << "Framebuffer incomplete: " << status << "\n";
-    }
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    return fbo;
-}
-
 void DestroyCachedBlur(CachedBlur& cb) {
     if (cb.tex) glDeleteTextures(1, &cb.tex);
     if (cb.fbo) glDeleteFramebuffers(1, &cb.fbo);
     cb = {};
 }
 
-struct QuadMesh {
-    GLuint vao = 0;
-    GLuint vbo = 0;
-    GLuint ebo = 0;
+// Progressive refinement settings.
+constexpr int kPreviewLod = 1;              // source mip level filtered while dragging
+constexpr double kSettleSeconds = 0.15;     // radius must stay put this long before refining mid-drag
+constexpr double kRefineBudgetMs = 4.0;     // GPU time per frame spent on full-res rows (vsync is ~16.6 ms)
+constexpr int kInitialRefineRows = 64;      // rows per frame until the first timer query lands
+constexpr int kMinRefineRows = 8;
+
+// While the radius is changing, a low-resolution preview is filtered from a mip of the
+// source and presented. Once input settles, the full-resolution cache is filled a band of
+// rows per frame, sized from GPU timer queries so the UI keeps presenting at vsync.
+struct QualityScheduler {
+    CachedBlur preview;
+    GLsizei previewWidth = 0;
+    GLsizei previewHeight = 0;
+    int previewLod = 0;
+    int previewRadius = 0;      // full-res radius the preview was built for (0 = none)
+    int refineRow = 0;          // next full-res row to filter into the cache
+    double lastChangeTime = 0.0;
+    double nsPerRowTap = 0.0;   // measured GPU cost of one row at one kernel tap (0 = unknown)
+    GLuint timerQuery = 0;
+    bool timerPending = false;
+    long long timedRowTaps = 0; // work covered by the pending timer query
 };
 
-QuadMesh CreateFullscreenQuad() {
-    // Positions (x, y) and UVs (u, v)
-    float vertices[] = {
-        -1.f, -1.f, 0.f, 0.f,
-         1.f, -1.f, 1.f, 0.f,
-         1.f,  1.f, 1.f, 1.f,
-        -1.f,  1.f, 0.f, 1.f,
-    };
-    unsigned int indices[] = {0, 1, 2, 2, 3, 0};
-
-    QuadMesh mesh;
-    glGenVertexArrays(1, &mesh.vao);
-    glGenBuffers(1, &mesh.vbo);
-    glGenBuffers(1, &mesh.ebo);
-
-    glBindVertexArray(mesh.vao);
-    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), reinterpret_cast<void*>(0));
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), reinterpret_cast<void*>(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    glBindVertexArray(0);
-    return mesh;
+int KernelTaps(int radius) {
+    int kernelSize = 2 * radius + 1;
+    return kernelSize * kernelSize;
+}
+
+// Radius in mip texels covering roughly the same footprint as `radius` at full res.
+int ScaleRadiusToLod(int radius, int lod) {
+    return std::max(1, static_cast<int>(std::lround(radius / static_cast<double>(1 << lod))));
+}
+
+QualityScheduler CreateQualityScheduler(GLsizei width, GLsizei height) {
+    QualityScheduler qs;
+    // Don't ask for a mip level the texture doesn't have.
+    while (qs.previewLod < kPreviewLod && (std::min(width, height) >> (qs.previewLod + 1)) > 0) {
+        ++qs.previewLod;
+    }
+    qs.previewWidth = std::max(1, width >> qs.previewLod);
+    qs.previewHeight = std::max(1, height >> qs.previewLod);
+    qs.preview.fbo = gfx::CreateFramebufferWithTexture(qs.previewWidth, qs.previewHeight, qs.preview.tex);
+    glGenQueries(1, &qs.timerQuery);
+    return qs;
+}
+
+void DestroyQualityScheduler(QualityScheduler& qs) {
+    DestroyCachedBlur(qs.preview);
+    if (qs.timerQuery) glDeleteQueries(1, &qs.timerQuery);
+    qs = {};
 }
 
-void DestroyMesh(QuadMesh& mesh) {
-    glDeleteBuffers(1, &mesh.ebo);
-    glDeleteBuffers(1, &mesh.vbo);
-    glDeleteVertexArrays(1, &mesh.vao);
-    mesh = {};
+// Restart refinement after the radius changed; the preview is rebuilt on next use.
+void InvalidateRefinement(QualityScheduler& qs, CachedBlur& target) {
+    target.ready = false;
+    qs.refineRow = 0;
+    qs.lastChangeTime = glfwGetTime();
+}
+
+void RenderPreview(QualityScheduler& qs, const ShaderProgram& program, const gfx::QuadMesh& quad,
+                   GLuint source, int radius) {
+    GLint prevViewport[4];
+    glGetIntegerv(GL_VIEWPORT, prevViewport);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, qs.preview.fbo);
+    glViewport(0, 0, qs.previewWidth, qs.previewHeight);
+
+    program.Use();
+    program.SetInt("uMode", 1);
+    program.SetInt("uTexture", 0);
+    program.SetInt("uLod", qs.previewLod);
+    program.SetInt("uRadius", ScaleRadiusToLod(radius, qs.previewLod));
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, source);
+
+    gfx::DrawQuad(quad);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+    qs.previewRadius = radius;
+}
+
+// Filters the next band of full-res rows into `target`, marking it ready after the last one.
+void AdvanceRefinement(QualityScheduler& qs, CachedBlur& target, const ShaderProgram& program,
+                       const gfx::QuadMesh& quad, GLuint source, GLsizei width, GLsizei height, int radius) {
+    // Pick up the previous band's GPU time without stalling on it.
+    if (qs.timerPending) {
+        GLint available = 0;
+        glGetQueryObjectiv(qs.timerQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available) {
+            GLuint64 elapsedNs = 0;
+            glGetQueryObjectui64v(qs.timerQuery, GL_QUERY_RESULT, &elapsedNs);
+            qs.timerPending = false;
+            if (elapsedNs > 0 && qs.timedRowTaps > 0) {
+                qs.nsPerRowTap = static_cast<double>(elapsedNs) / static_cast<double>(qs.timedRowTaps);
+            }
+        }
+    }
+
+    int rows = kInitialRefineRows;
+    if (qs.nsPerRowTap > 0.0) {
+        double budgetRows = kRefineBudgetMs * 1.0e6 / (qs.nsPerRowTap * KernelTaps(radius));
+        rows = static_cast<int>(std::min(budgetRows, static_cast<double>(height)));
+    }
+    rows = std::min(std::max(rows, kMinRefineRows), height - qs.refineRow);
+
+    GLint prevViewport[4];
+    glGetIntegerv(GL_VIEWPORT, prevViewport);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glViewport(0, 0, width, height);
+
+    program.Use();
+    program.SetInt("uMode", 1);
+    program.SetInt("uTexture", 0);
+    program.SetInt("uLod", 0);
+    program.SetInt("uRadius", radius);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, source);
+
+    // Only one query in flight; untimed bands reuse the last measurement.
+    bool timed = !qs.timerPending;
+    if (timed) {
+        glBeginQuery(GL_TIME_ELAPSED, qs.timerQuery);
+    }
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(0, qs.refineRow, width, rows);
+    gfx::DrawQuad(quad);
+    glDisable(GL_SCISSOR_TEST);
+    if (timed) {
+        glEndQuery(GL_TIME_ELAPSED);
+        qs.timerPending = true;
+        qs.timedRowTaps = static_cast<long long>(rows) * KernelTaps(radius);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+
+    qs.refineRow += rows;
+    if (qs.refineRow >= height) {
+        target.ready = true;
+    }
 }
 
 } // namespace
@@ -183,7 +240,7 @@ int main() {
         return 1;
     }
 
-    QuadMesh quad = CreateFullscreenQuad();
+    gfx::QuadMesh quad = gfx::CreateFullscreenQuad();
 
     program.Use();
     program.SetInt("uTexture", 0);
@@ -204,7 +261,9 @@ int main() {
     glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &texWidth);
     glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &texHeight);
     glBindTexture(GL_TEXTURE_2D, 0);
-    cached.fbo = CreateFramebufferWithTexture(texWidth, texHeight, cached.tex);
+    cached.fbo = gfx::CreateFramebufferWithTexture(texWidth, texHeight, cached.tex);
+    // Preview + progressive refinement of the cache while the radius is being dragged.
+    QualityScheduler scheduler = CreateQualityScheduler(texWidth, texHeight);
 
     while (!glfwWindowShouldClose(window)) {
         glfwPollEvents();
@@ -252,7 +311,7 @@ int main() {
             newRadius = ClampInt(newRadius, minRadius, maxRadius);
             if (newRadius != radius) {
                 radius = newRadius;
-                cached.ready = false; // invalidate cache when radius changes
+                InvalidateRefinement(scheduler, cached); // invalidate cache when radius changes
                 std::cout << "Radius set to: " << radius << "\n";
             }
         }
@@ -264,30 +323,16 @@ int main() {
         glClearColor(0.05f, 0.05f, 0.05f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
-        // If filtered view is requested and cache for current radius is not ready, render once into cache.
+        // If filtered view is requested and cache for current radius is not ready, present a cheap
+        // low-res preview and, once the radius has settled, refine the cache a band per frame.
         if (showFiltered && !cached.ready) {
-            GLint prevViewport[4];
-            glGetIntegerv(GL_VIEWPORT, prevViewport);
-
-            glBindFramebuffer(GL_FRAMEBUFFER, cached.fbo);
-            glViewport(0, 0, texWidth, texHeight);
-            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-            glClear(GL_COLOR_BUFFER_BIT);
-
-            program.Use();
-            program.SetInt("uMode", 1);
-            program.SetInt("uTexture", 0);
-            program.SetInt("uRadius", radius);
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, texture);
-
-            glBindVertexArray(quad.vao);
-            glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
-            glBindVertexArray(0);
-
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
-            glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
-            cached.ready = true;
+            if (scheduler.previewRadius != radius) {
+                RenderPreview(scheduler, program, quad, texture, radius);
+            }
+            bool settled = !sliderDragging || (glfwGetTime() - scheduler.lastChangeTime) >= kSettleSeconds;
+            if (settled) {
+                AdvanceRefinement(scheduler, cached, program, quad, texture, texWidth, texHeight, radius);
+            }
         }
 
         // Present: choose source texture based on mode (cached blur or original).
@@ -296,14 +341,12 @@ int main() {
         program.SetInt("uTexture", 0);
         glActiveTexture(GL_TEXTURE0);
         if (showFiltered) {
-            glBindTexture(GL_TEXTURE_2D, cached.tex);
+            glBindTexture(GL_TEXTURE_2D, cached.ready ? cached.tex : scheduler.preview.tex);
         } else {
             glBindTexture(GL_TEXTURE_2D, texture);
         }
 
-        glBindVertexArray(quad.vao);
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
-        glBindVertexArray(0);
+        gfx::DrawQuad(quad);
 
         // Simple on-screen button: draw a colored rectangle using scissor clear.
         // Green when filtered, gray when original. No text (keeps dependencies zero).
@@ -338,8 +381,9 @@ int main() {
     }
 
     glDeleteTextures(1, &texture);
-    DestroyMesh(quad);
+    gfx::DestroyMesh(quad);
     DestroyCachedBlur(cached);
+    DestroyQualityScheduler(scheduler);
     glfwTerminate();
     return 0;
 }